@@ -1,10 +1,14 @@
 #pragma once
 #include <raylib.h>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class ThreadPool;
+
 class Terminal {
 public:
   using CommandFunc = std::function<void(const std::vector<std::string>&)>;
@@ -41,6 +45,46 @@ private:
   float font_size_{16.0f};  // Default font size for content area
   Color background_color_{(Color){20, 20, 20, 240}};
 
+  /* Watch */
+  struct WatchLine {
+    std::string text;
+    Color color{GREEN};
+    bool dirty{true};
+  };
+  static constexpr int kWatchMaxLines = 12;  // Rows pinned below the title (incl. header)
+  static constexpr float kWatchMinInterval = 0.1f;
+  static constexpr float kWatchMaxInterval = 3600.0f;
+  std::string watch_command_;   // Empty when no watch is active
+  float watch_interval_{1.0f};  // Seconds between re-runs
+  float watch_timer_{0.0f};
+  std::vector<WatchLine> watch_lines_;              // Last rendered result, one slot per row
+  int watch_rows_used_{0};                          // Rows holding content (header + output)
+  std::vector<std::string>* output_sink_{nullptr};  // Captures AddOutput while a watch runs
+  RenderTexture2D watch_texture_{};                 // Cached rows, only dirty ones are redrawn
+  float watch_texture_font_size_{0.0f};
+  Vector2 watch_texture_scale_{0.0f, 0.0f};  // DPI scale the texture was allocated for
+
+  /* Recursive search (find / grep -r) */
+  // One node per visited path. Workers fill `lines` and `children`, then publish with `done`;
+  // the main thread streams nodes out in pre-order, so output order never depends on timing.
+  struct SearchNode {
+    std::vector<std::string> lines;
+    std::vector<std::unique_ptr<SearchNode>> children;
+    std::atomic<bool> done{false};
+  };
+  struct SearchJob {
+    bool grep{false};          // grep -r when true, find otherwise
+    bool prefix_paths{false};  // Prefix grep matches with "path:" (directory searches)
+    std::string pattern;       // -name glob for find, fixed string for grep
+    std::atomic<bool> cancelled{false};
+    SearchNode root;
+    std::vector<std::pair<SearchNode*, size_t>> cursor;  // Pre-order walk: node, next child
+  };
+  static constexpr int kSearchLinesPerFrame = 512;
+  static constexpr int kSearchNodesPerFrame = 4096;
+  static constexpr size_t kSearchFilesPerTask = 64;  // grep scans files in batches
+  std::shared_ptr<SearchJob> search_;
+
   /* Backspace handling */
   bool backspace_held_{false};
   float backspace_timer_{0.0f};
@@ -51,10 +95,30 @@ private:
   void HandleCursorBlink(float dt);  // 更新光标闪烁
   void HandleBackspace(float dt);    // 处理长按删除
   void UpdateAnimation(float dt);    // 更新划入滑出动画
+  void UpdateWatch(float dt);        // 定时重新执行 watch 命令
+  void UpdateSearch();               // 输出已完成的搜索结果
 
   void ProcessCommand(const std::string& command);
   void AddOutput(const std::string& text);
   void InitializeFilesystem();
+  void ScrollToBottom();
+  float HeaderHeight();
+  Color LineColor(const std::string& line);
+
+  /* Watch */
+  void StartWatch(const std::string& command, float interval);
+  void StopWatch();
+  void RunWatch();
+  float DrawWatch(float x, float y, float line_height);
+  float WatchHeight(float line_height);
+
+  /* Search */
+  void StartSearch(bool grep, const std::string& pattern, const std::string& path);
+  void CancelSearch();
+  void InterruptSearch();
+  void SearchPath(ThreadPool* pool, const std::shared_ptr<SearchJob>& job, SearchNode* node,
+                  const std::string& path);
+  void ScanFile(const SearchJob& job, SearchNode* node, const std::string& path);
 
   /* Commands */
   void CmdLs(const std::vector<std::string>& args);
@@ -65,6 +129,9 @@ private:
   void CmdClear(const std::vector<std::string>& args);
   void CmdPwd(const std::vector<std::string>& args);
   void CmdSet(const std::vector<std::string>& args);
+  void CmdWatch(const std::vector<std::string>& args);
+  void CmdFind(const std::vector<std::string>& args);
+  void CmdGrep(const std::vector<std::string>& args);
   std::unordered_map<std::string, CommandFunc> command_table_;
 
   /* Utilities */
@@ -73,4 +140,9 @@ private:
   std::string ResolvePath(const std::string& path);
   bool PathExists(const std::string& path);
   bool IsDirectory(const std::string& path);
+  std::string BaseName(const std::string& path);
+  bool GlobMatch(const std::string& pattern, const std::string& name);
+
+  // Declared last so it is destroyed first: queued tasks still read the filesystem maps
+  std::unique_ptr<ThreadPool> search_pool_;
 };
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool.
+// Each worker owns a deque: it pushes/pops its own tasks at the back (LIFO, cache friendly) and
+// steals from the front of other workers' deques (FIFO, oldest = usually largest subtree) when
+// its own deque runs dry. Tasks submitted from a worker stay on that worker's deque.
+// Submit() only touches the shared wake mutex when some worker is actually asleep.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(size_t count = std::thread::hardware_concurrency()) {
+    if (count == 0) count = 1;
+    for (size_t i = 0; i < count; ++i) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+      workers_.emplace_back([this, i] { WorkerLoop(i); });
+    }
+  }
+
+  // Runs every queued task before joining
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Submit(Task task) {
+    size_t index = current_pool_ == this ? current_index_ : next_++ % queues_.size();
+    // Count before publishing so a worker can never take the task ahead of the increment
+    ++pending_;
+    {
+      std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+      queues_[index]->tasks.push_back(std::move(task));
+    }
+    // A worker registers in sleeping_ before re-checking pending_ under wake_mutex_, so either it
+    // sees the task or we see it and wake it. The empty critical section closes the gap between
+    // its check and its wait.
+    if (sleeping_ > 0) {
+      { std::lock_guard<std::mutex> lock(wake_mutex_); }
+      wake_.notify_one();
+    }
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool Pop(size_t index, Task& task) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+  }
+
+  bool Steal(size_t index, Task& task) {
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+      Queue& queue = *queues_[(index + offset) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) continue;
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  void WorkerLoop(size_t index) {
+    current_pool_ = this;
+    current_index_ = index;
+    while (true) {
+      Task task;
+      if (Pop(index, task) || Steal(index, task)) {
+        --pending_;
+        task();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      ++sleeping_;
+      wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+      --sleeping_;
+      if (stop_ && pending_ == 0) return;
+    }
+  }
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> pending_{0};   // Tasks queued but not yet picked up
+  std::atomic<size_t> next_{0};      // Round-robin target for external submissions
+  std::atomic<size_t> sleeping_{0};  // Workers blocked (or about to block) on wake_
+  bool stop_{false};
+
+  inline static thread_local ThreadPool* current_pool_{nullptr};
+  inline static thread_local size_t current_index_{0};
+};
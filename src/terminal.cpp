@@ -1,11 +1,13 @@
 #include "terminal.h"
 #include <raylib.h>
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <functional>
 #include <sstream>
 #include "managers/font-manager.h"
 #include "utilities/color.h"
+#include "utilities/thread-pool.h"
 
 Terminal::Terminal() : current_directory_("/home/player") {
   command_table_ = {
@@ -16,6 +18,9 @@ Terminal::Terminal() : current_directory_("/home/player") {
       {"clear", [this](auto& args) { CmdClear(args); }},
       {"echo", [this](auto& args) { CmdEcho(args); }},
       {"set", [this](auto& args) { CmdSet(args); }},
+      {"watch", [this](auto& args) { CmdWatch(args); }},
+      {"find", [this](auto& args) { CmdFind(args); }},
+      {"grep", [this](auto& args) { CmdGrep(args); }},
       {"help", [this](auto& args) { CmdHelp(args); }},
   };
   InitializeFilesystem();
@@ -24,13 +29,21 @@ Terminal::Terminal() : current_directory_("/home/player") {
   AddOutput("");
 }
 
-Terminal::~Terminal() {}
+Terminal::~Terminal() {
+  // Join the search workers before anything they read is torn down
+  CancelSearch();
+  search_pool_.reset();
+  // The window (and its GL context) may already be gone when we are destroyed
+  if (watch_texture_.id != 0 && IsWindowReady()) UnloadRenderTexture(watch_texture_);
+}
 
 void Terminal::Update(float dt) {
   HandleInput();
   HandleBackspace(dt);
   HandleCursorBlink(dt);
   UpdateAnimation(dt);
+  UpdateWatch(dt);
+  UpdateSearch();
 }
 
 // clang-format off
@@ -57,26 +70,21 @@ void Terminal::Draw() {
                FontSize::kTitle, 1.0f, WHITE);
   }
 
-  // Terminal content area
-  float content_y = title_y + title_text_size.y + 20.0f;
+  // Terminal content area, below the pinned watch region (if any)
+  float content_y = HeaderHeight();
+  content_y += DrawWatch(panel_x + 10.0f, content_y, line_height);
   float content_height = panel_height - content_y - 40.0f;  // Leave space for current input
 
+  // Keep scrolled history from bleeding into the watch region
+  BeginScissorMode(panel_x, content_y, current_panel_width_, panel_height - content_y);
+
   // Draw output history
   float y_offset = content_y - scroll_offset_;
 
   for (const auto& line : output_history_) {
     if (y_offset > content_y - line_height && y_offset < content_y + content_height) {
-      Color text_color = GREEN;
-      // Different colors for different types of text
-      if (line.find("$") != std::string::npos && line.find("/") != std::string::npos) {
-        text_color = YELLOW;  // Command lines
-      } else if (line.find("bash:") != std::string::npos ||
-                 line.find("cannot access") != std::string::npos) {
-        text_color = RED;  // Error messages
-      }
-
       DrawTextEx(FontManager::Get().Mono(), line.c_str(), {panel_x + 10.0f, y_offset},
-                 font_size_, 1.0f, text_color);
+                 font_size_, 1.0f, LineColor(line));
     }
     y_offset += line_height;
   }
@@ -96,6 +104,61 @@ void Terminal::Draw() {
       DrawRectangle(panel_x + 10.0f + prompt_size.x, y_offset, 2.0f, font_size_, WHITE);
     }
   }
+
+  EndScissorMode();
+}
+
+// Draw the watch region from its cached texture, redrawing only rows that changed
+float Terminal::DrawWatch(float x, float y, float line_height) {
+  if (watch_command_.empty()) return 0.0f;
+
+  // The texture is allocated in physical pixels so text stays as sharp as the scrollback on HiDPI
+  float width = max_panel_width_ - 20.0f;
+  float height = kWatchMaxLines * line_height;
+  Vector2 scale = GetWindowScaleDPI();
+  if (watch_texture_.id == 0 || watch_texture_font_size_ != font_size_ ||
+      watch_texture_scale_.x != scale.x || watch_texture_scale_.y != scale.y) {
+    if (watch_texture_.id != 0) UnloadRenderTexture(watch_texture_);
+    watch_texture_ = LoadRenderTexture(width * scale.x, height * scale.y);
+    watch_texture_font_size_ = font_size_;
+    watch_texture_scale_ = scale;
+    for (auto& row : watch_lines_) row.dirty = true;
+  }
+
+  bool any_dirty = std::any_of(watch_lines_.begin(), watch_lines_.end(),
+                               [](const WatchLine& row) { return row.dirty; });
+  if (any_dirty) {
+    BeginTextureMode(watch_texture_);
+    for (size_t i = 0; i < watch_lines_.size(); ++i) {
+      WatchLine& row = watch_lines_[i];
+      if (!row.dirty) continue;
+      float row_y = i * line_height * scale.y;
+      // Clear just this row
+      BeginScissorMode(0, row_y, watch_texture_.texture.width, line_height * scale.y);
+      ClearBackground(BLANK);
+      EndScissorMode();
+      DrawTextEx(FontManager::Get().Mono(), row.text.c_str(), {0.0f, row_y}, font_size_ * scale.y,
+                 scale.x, row.color);
+      row.dirty = false;
+    }
+    EndTextureMode();
+  }
+
+  // Render textures are stored bottom-up, so sample the top rows with a flipped source rect
+  // and scale it back down to logical pixels
+  float used_height = watch_rows_used_ * line_height;
+  Rectangle source = {0.0f, (height - used_height) * scale.y, width * scale.x,
+                      -used_height * scale.y};
+  Rectangle dest = {x, y, width, used_height};
+  DrawTexturePro(watch_texture_.texture, source, dest, {0.0f, 0.0f}, 0.0f, WHITE);
+  float separator_y = y + used_height + 4.0f;
+  DrawLine(x, separator_y, x + width, separator_y, (Color){100, 100, 100, 255});
+  return WatchHeight(line_height);
+}
+
+float Terminal::WatchHeight(float line_height) {
+  if (watch_command_.empty()) return 0.0f;
+  return watch_rows_used_ * line_height + 10.0f;  // Rows plus the separator gap
 }
 // clang-format on
 
@@ -135,7 +198,15 @@ void Terminal::HandleInput() {
     backspace_timer_ = 0.0f;
   }
 
+  // Ctrl+C stops a running find / grep
+  if ((IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) && IsKeyPressed(KEY_C)) {
+    InterruptSearch();
+  }
+
   if (IsKeyPressed(KEY_ENTER)) {
+    // A new command ends the running search so their output does not interleave
+    InterruptSearch();
+
     // Add the current command line to history
     std::string command_line = current_directory_ + "$ " + current_input_;
     AddOutput(command_line);
@@ -202,6 +273,46 @@ void Terminal::HandleCursorBlink(float dt) {
   }
 }
 
+// Re-run the watched command on its timer, only while the panel is open
+void Terminal::UpdateWatch(float dt) {
+  if (watch_command_.empty() || !is_open_) return;
+
+  watch_timer_ += dt;
+  if (watch_timer_ < watch_interval_) return;
+  watch_timer_ = 0.0f;
+  RunWatch();
+}
+
+// Stream finished search nodes into the history in pre-order, stopping at the first node a
+// worker has not published yet so the output order is the same on every run
+void Terminal::UpdateSearch() {
+  if (!search_) return;
+
+  // Budget both lines and nodes, a sparse search can walk many nodes without printing anything
+  int emitted = 0;
+  int visited = 0;
+  auto& cursor = search_->cursor;
+  while (!cursor.empty() && emitted < kSearchLinesPerFrame && visited++ < kSearchNodesPerFrame) {
+    auto& [node, next_child] = cursor.back();
+    if (!node->done.load(std::memory_order_acquire)) return;
+
+    // Printed results live in output_history_ from here on, so drop the node's copies
+    if (next_child == 0) {
+      for (const auto& line : node->lines) AddOutput(line);
+      emitted += node->lines.size();
+      std::vector<std::string>().swap(node->lines);
+    }
+    if (next_child < node->children.size()) {
+      SearchNode* child = node->children[next_child++].get();
+      cursor.emplace_back(child, 0);
+    } else {
+      std::vector<std::unique_ptr<SearchNode>>().swap(node->children);
+      cursor.pop_back();
+    }
+  }
+  if (cursor.empty()) search_.reset();
+}
+
 // Toggle Animation
 void Terminal::UpdateAnimation(float dt) {
   float target_width = is_open_ ? max_panel_width_ : 0.0f;
@@ -231,13 +342,191 @@ void Terminal::ProcessCommand(const std::string& command) {
 }
 
 void Terminal::AddOutput(const std::string& text) {
+  if (output_sink_) {
+    output_sink_->push_back(text);
+    return;
+  }
+
   output_history_.push_back(text);
+  ScrollToBottom();
+}
+
+// Auto-scroll so the newest output and the input line sit at the bottom of the content area
+void Terminal::ScrollToBottom() {
+  float line_height = font_size_ + 4.0f;
+  float content_y = HeaderHeight() + WatchHeight(line_height);
+  float visible_height = GetScreenHeight() - content_y - 40.0f;  // Same as Draw()
+  float total_height = (output_history_.size() + 1) * line_height;  // +1 for current input line
+  // The visible height changes with the watch region, so the offset may need to shrink too
+  scroll_offset_ = std::max(0.0f, total_height - visible_height);
+}
+
+// Height of the title block above the content area
+float Terminal::HeaderHeight() {
+  Vector2 title_text_size =
+      MeasureTextEx(FontManager::Get().Italic(), "Game Terminal", FontSize::kTitle, 1.0f);
+  return 10.0f + title_text_size.y + 20.0f;
+}
+
+Color Terminal::LineColor(const std::string& line) {
+  // Different colors for different types of text
+  if (line.find("$") != std::string::npos && line.find("/") != std::string::npos) {
+    return YELLOW;  // Command lines
+  } else if (line.find("bash:") != std::string::npos ||
+             line.find("cannot access") != std::string::npos) {
+    return RED;  // Error messages
+  }
+  return GREEN;
+}
+
+void Terminal::StartWatch(const std::string& command, float interval) {
+  watch_command_ = command;
+  watch_interval_ = interval;
+  watch_timer_ = 0.0f;
+  watch_lines_.assign(kWatchMaxLines, WatchLine{});
+  RunWatch();
+}
+
+void Terminal::StopWatch() {
+  watch_command_.clear();
+  watch_lines_.clear();
+  watch_rows_used_ = 0;
+  ScrollToBottom();
+}
+
+// Run the watched command with its output captured instead of appended to the history,
+// then mark only the rows whose text differs from the previous run as dirty
+void Terminal::RunWatch() {
+  std::vector<std::string> lines;
+  lines.push_back("Every " + std::to_string(std::lround(watch_interval_ * 1000.0f)) +
+                  "ms: " + watch_command_);
+
+  output_sink_ = &lines;
+  ProcessCommand(watch_command_);
+  output_sink_ = nullptr;
+
+  if (lines.size() > kWatchMaxLines) lines[kWatchMaxLines - 1] = "...";  // Mark truncation
+  int rows_used = std::min<int>(lines.size(), kWatchMaxLines);
+  lines.resize(kWatchMaxLines);  // Pad with blanks so stale rows get cleared
+
+  for (size_t i = 0; i < watch_lines_.size(); ++i) {
+    WatchLine& row = watch_lines_[i];
+    if (row.text == lines[i]) continue;
+    row.text = lines[i];
+    row.color = i == 0 ? LIGHTGRAY : LineColor(row.text);
+    row.dirty = true;
+  }
+
+  // The region grew or shrank, so the input line may have moved out of view
+  if (rows_used != watch_rows_used_) {
+    watch_rows_used_ = rows_used;
+    ScrollToBottom();
+  }
+}
+
+void Terminal::StartSearch(bool grep, const std::string& pattern, const std::string& path) {
+  CancelSearch();
+  if (!search_pool_) search_pool_ = std::make_unique<ThreadPool>();
+
+  auto job = std::make_shared<SearchJob>();
+  job->grep = grep;
+  job->prefix_paths = IsDirectory(path);
+  job->pattern = pattern;
+  job->cursor.emplace_back(&job->root, 0);
+  search_ = job;
+  ThreadPool* pool = search_pool_.get();
+  pool->Submit([this, pool, job, path] { SearchPath(pool, job, &job->root, path); });
+}
+
+void Terminal::CancelSearch() {
+  if (!search_) return;
+  search_->cancelled = true;
+  search_.reset();  // In-flight tasks keep the job alive until they finish
+}
+
+// Stop the running search on user request, marking where its output ends
+void Terminal::InterruptSearch() {
+  if (!search_) return;
+  CancelSearch();
+  AddOutput("^C");
+}
+
+// Runs on a search pool worker. Only reads virtual_filesystem_ / virtual_files_, which are not
+// modified after InitializeFilesystem(). Subdirectories become child tasks so idle workers can
+// steal them. Consecutive files share one node: find matches them inline, grep scans them as a
+// task of up to kSearchFilesPerTask files.
+void Terminal::SearchPath(ThreadPool* pool, const std::shared_ptr<SearchJob>& job,
+                          SearchNode* node, const std::string& path) {
+  auto dir = virtual_filesystem_.find(path);
+  if (job->cancelled || dir == virtual_filesystem_.end()) {
+    ScanFile(*job, node, path);
+    node->done.store(true, std::memory_order_release);
+    return;
+  }
+
+  if (!job->grep && GlobMatch(job->pattern, BaseName(path))) node->lines.push_back(path);
+
+  SearchNode* run = nullptr;  // Node collecting the current run of files
+  std::vector<std::string> batch;
+  auto close_run = [&] {
+    if (!run) return;
+    if (job->grep) {
+      pool->Submit([this, job, run, batch = std::move(batch)] {
+        for (const auto& file_path : batch) ScanFile(*job, run, file_path);
+        run->done.store(true, std::memory_order_release);
+      });
+      batch.clear();
+    } else if (run->lines.empty()) {
+      node->children.pop_back();  // Nothing matched, no need to keep the node around
+    } else {
+      run->done.store(true, std::memory_order_release);
+    }
+    run = nullptr;
+  };
+
+  for (const auto& item : dir->second) {
+    if (job->cancelled) break;
+    std::string child_path = JoinPath(path, item);
+
+    if (IsDirectory(child_path)) {
+      close_run();
+      node->children.push_back(std::make_unique<SearchNode>());
+      SearchNode* child = node->children.back().get();
+      pool->Submit([this, pool, job, child, child_path] {
+        SearchPath(pool, job, child, child_path);
+      });
+      continue;
+    }
+
+    if (!run) {
+      node->children.push_back(std::make_unique<SearchNode>());
+      run = node->children.back().get();
+    }
+    if (job->grep) {
+      batch.push_back(std::move(child_path));
+      if (batch.size() == kSearchFilesPerTask) close_run();
+    } else {
+      ScanFile(*job, run, child_path);  // A name match is too cheap to hand off
+    }
+  }
+  close_run();
+  node->done.store(true, std::memory_order_release);
+}
 
-  // Auto-scroll to bottom when new content is added
-  float total_height = (output_history_.size() + 1) * 20.0f;  // +1 for current input line
-  float visible_height = GetScreenHeight() * 0.7f;            // Content area height
-  if (total_height > visible_height) {
-    scroll_offset_ = total_height - visible_height + 20.0f;  // Extra padding to show current line
+// Append a single file's matches to `node`; the caller publishes it
+void Terminal::ScanFile(const SearchJob& job, SearchNode* node, const std::string& path) {
+  if (job.cancelled) return;
+  if (job.grep) {
+    auto file = virtual_files_.find(path);
+    if (file == virtual_files_.end()) return;
+    std::stringstream ss(file->second);
+    std::string line;
+    while (std::getline(ss, line)) {
+      if (line.find(job.pattern) == std::string::npos) continue;
+      node->lines.push_back(job.prefix_paths ? path + ":" + line : line);
+    }
+  } else if (GlobMatch(job.pattern, BaseName(path))) {
+    node->lines.push_back(path);
   }
 }
 
@@ -344,9 +633,14 @@ void Terminal::CmdHelp(const std::vector<std::string>& args) {
   AddOutput("  pwd                - Print working directory");
   AddOutput("  clear              - Clear terminal");
   AddOutput("  set <prop> <val>   - Change terminal settings");
+  AddOutput("  watch -n <ms> cmd  - Re-run a command in a pinned region");
+  AddOutput("  watch stop         - Stop the active watch");
+  AddOutput("  find [dir] -name p - Recursively find paths matching glob p");
+  AddOutput("  grep -r <txt> dir  - Recursively search file contents");
   AddOutput("  help               - Show this help");
   AddOutput("");
   AddOutput("Use \\ key to toggle terminal");
+  AddOutput("Use Ctrl+C to stop a running find or grep");
 }
 
 void Terminal::CmdClear(const std::vector<std::string>& args) {
@@ -413,6 +707,108 @@ void Terminal::CmdSet(const std::vector<std::string>& args) {
   }
 }
 
+void Terminal::CmdWatch(const std::vector<std::string>& args) {
+  if (args.size() < 2) {
+    AddOutput("Usage: watch [-n <ms>] <command>");
+    AddOutput("       watch stop");
+    return;
+  }
+
+  if (args[1] == "stop") {
+    if (watch_command_.empty()) {
+      AddOutput("watch: no active watch");
+    } else {
+      StopWatch();
+    }
+    return;
+  }
+
+  float interval = 1.0f;
+  size_t first = 1;
+  if (args[1] == "-n") {
+    if (args.size() < 4) {
+      AddOutput("watch: missing interval or command");
+      return;
+    }
+    try {
+      size_t pos = 0;
+      interval = std::stof(args[2], &pos) / 1000.0f;
+      if (pos != args[2].size()) interval = NAN;  // Trailing garbage such as "5abc"
+    } catch (const std::exception& e) {
+      interval = NAN;
+    }
+    // stof also accepts "nan" / "inf" and negative values
+    if (!std::isfinite(interval) || interval <= 0.0f || interval > kWatchMaxInterval) {
+      AddOutput("watch: invalid interval '" + args[2] + "'");
+      return;
+    }
+    first = 3;
+  }
+
+  std::string name = args[first];
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  // find / grep stream into the history asynchronously, so they cannot be captured
+  if (name == "watch" || name == "clear" || name == "find" || name == "grep") {
+    AddOutput("watch: '" + name + "' cannot be watched");
+    return;
+  }
+
+  std::string command;
+  for (size_t i = first; i < args.size(); ++i) {
+    if (i > first) command += " ";
+    command += args[i];
+  }
+  StartWatch(command, std::max(interval, kWatchMinInterval));
+}
+
+void Terminal::CmdFind(const std::vector<std::string>& args) {
+  std::string path = current_directory_;
+  std::string pattern = "*";
+
+  for (size_t i = 1; i < args.size(); ++i) {
+    if (args[i] == "-name") {
+      if (i + 1 >= args.size()) {
+        AddOutput("find: missing argument to '-name'");
+        return;
+      }
+      pattern = args[++i];
+    } else if (args[i][0] == '-') {
+      AddOutput("find: unknown predicate '" + args[i] + "'");
+      return;
+    } else {
+      path = ResolvePath(args[i]);
+    }
+  }
+
+  if (!PathExists(path)) {
+    AddOutput("find: '" + path + "': No such file or directory");
+    return;
+  }
+  StartSearch(false, pattern, path);
+}
+
+void Terminal::CmdGrep(const std::vector<std::string>& args) {
+  bool recursive = args.size() > 1 && args[1] == "-r";
+  size_t first = recursive ? 2 : 1;
+  if (args.size() <= first) {
+    AddOutput("Usage: grep [-r] <text> [path]");
+    return;
+  }
+
+  const std::string& pattern = args[first];
+  std::string path = args.size() > first + 1 ? ResolvePath(args[first + 1]) : current_directory_;
+
+  if (!PathExists(path)) {
+    AddOutput("grep: " + path + ": No such file or directory");
+    return;
+  }
+  if (IsDirectory(path) && !recursive) {
+    AddOutput("grep: " + path + ": Is a directory");
+    return;
+  }
+  StartSearch(true, pattern, path);
+}
+
 std::vector<std::string> Terminal::SplitCommand(const std::string& command) {
   std::vector<std::string> result;
   std::stringstream ss(command);
@@ -462,3 +858,30 @@ bool Terminal::PathExists(const std::string& path) {
 bool Terminal::IsDirectory(const std::string& path) {
   return virtual_filesystem_.find(path) != virtual_filesystem_.end();
 }
+
+std::string Terminal::BaseName(const std::string& path) {
+  if (path == "/") return path;
+  return path.substr(path.find_last_of('/') + 1);
+}
+
+// Shell-style glob supporting '*' and '?'
+bool Terminal::GlobMatch(const std::string& pattern, const std::string& name) {
+  size_t p = 0, n = 0;
+  size_t star = std::string::npos, retry = 0;
+  while (n < name.size()) {
+    if (p < pattern.size() && pattern[p] == '*') {  // Before literals, a name may contain '*'
+      star = p++;
+      retry = n;
+    } else if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+      ++p;
+      ++n;
+    } else if (star != std::string::npos) {
+      p = star + 1;
+      n = ++retry;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') ++p;
+  return p == pattern.size();
+}